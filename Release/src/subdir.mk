@@ -4,15 +4,21 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../src/colourindex.cpp \
 ../src/main.cpp \
+../src/summary.cpp \
 ../src/threecolours.cpp 
 
 OBJS += \
+./src/colourindex.o \
 ./src/main.o \
+./src/summary.o \
 ./src/threecolours.o 
 
 CPP_DEPS += \
+./src/colourindex.d \
 ./src/main.d \
+./src/summary.d \
 ./src/threecolours.d 
 
 
@@ -0,0 +1,182 @@
+/*
+ * ColourIndex.cpp
+ *
+ *  Created on: 19 Oct 2026
+ */
+
+#include "colourindex.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "norm.h"
+
+using namespace tc;
+
+ColourIndex::ColourIndex(const cv::Mat & image, const std::vector< double > & knorm, double radius)
+   : m_image(image)
+   , m_knorm(knorm)
+   , m_radius(radius)
+{
+}
+
+ColourIndex::~ColourIndex()
+{
+}
+
+LinearColourIndex::LinearColourIndex(const cv::Mat & image, const std::vector< double > & knorm, double radius)
+   : ColourIndex(image, knorm, radius)
+{
+   for (int x = 0; x < image.size().width; x++)
+   {
+      for (int y = 0; y < image.size().height; y++)
+      {
+         m_pixels.push_back({x, y});
+      }
+   }
+}
+
+bool LinearColourIndex::next(pixel_type & pixel)
+{
+   if (m_pixels.empty())
+   {
+      return false;
+   }
+
+   pixel = m_pixels.front();
+   m_pixels.erase(m_pixels.begin());
+
+   return true;
+}
+
+void LinearColourIndex::extract(const cv::Vec3b & colour, pixels_type & pixels)
+{
+   for (auto pixel = m_pixels.begin(); pixel != m_pixels.end(); )
+   {
+      auto p = m_image.at< cv::Vec3b >((* pixel)[1], (* pixel)[0]);
+
+      if (norm(colour, p, m_knorm) < m_radius)
+      {
+         pixels.push_back(* pixel);
+         pixel = m_pixels.erase(pixel);
+      }
+      else
+      {
+         ++pixel;
+      }
+   }
+}
+
+GridColourIndex::GridColourIndex(const cv::Mat & image, const std::vector< double > & knorm, double radius)
+   : ColourIndex(image, knorm, radius)
+   , m_next(0)
+{
+   double maxScale = ::sqrt(* std::max_element(knorm.begin(), knorm.begin() + 3));
+   // never less than the radius (with some slack for rounding), never more than 64 cells per side
+   double cellSize = std::max(radius * 1.000001, 256 * maxScale / 64);
+
+   for (int i = 0; i < 3; i++)
+   {
+      m_scale[i] = ::sqrt(knorm[i]) / cellSize;
+      m_cells[i] = (int)(255 * m_scale[i]) + 1;
+   }
+   m_grid.resize(m_cells[0] * m_cells[1] * m_cells[2]);
+
+   int pixels = image.size().width * image.size().height;
+   m_cellOf.resize(pixels);
+   m_positionOf.resize(pixels);
+
+   // ids follow the column order of the pixels
+   for (int id = 0; id < pixels; id++)
+   {
+      int x = id / image.size().height;
+      int y = id % image.size().height;
+
+      auto c = cell(image.at< cv::Vec3b >(y, x));
+      auto index = cellIndex(c[0], c[1], c[2]);
+
+      m_cellOf[id] = index;
+      m_positionOf[id] = m_grid[index].size();
+      m_grid[index].push_back(id);
+   }
+}
+
+bool GridColourIndex::next(pixel_type & pixel)
+{
+   while (m_next < m_cellOf.size() and m_cellOf[m_next] < 0)
+   {
+      m_next++;
+   }
+
+   if (m_next == m_cellOf.size())
+   {
+      return false;
+   }
+
+   int id = m_next;
+   erase(id);
+
+   pixel = {id / m_image.size().height, id % m_image.size().height};
+
+   return true;
+}
+
+void GridColourIndex::extract(const cv::Vec3b & colour, pixels_type & pixels)
+{
+   auto c = cell(colour);
+
+   for (int c0 = std::max(c[0] - 1, 0); c0 <= std::min(c[0] + 1, m_cells[0] - 1); c0++)
+   {
+      for (int c1 = std::max(c[1] - 1, 0); c1 <= std::min(c[1] + 1, m_cells[1] - 1); c1++)
+      {
+         for (int c2 = std::max(c[2] - 1, 0); c2 <= std::min(c[2] + 1, m_cells[2] - 1); c2++)
+         {
+            auto & ids = m_grid[cellIndex(c0, c1, c2)];
+
+            for (std::size_t i = 0; i < ids.size(); )
+            {
+               int id = ids[i];
+               int x = id / m_image.size().height;
+               int y = id % m_image.size().height;
+
+               if (norm(colour, m_image.at< cv::Vec3b >(y, x), m_knorm) < m_radius)
+               {
+                  pixels.push_back({x, y});
+                  // the last id of the cell is moved here, so i is not incremented
+                  erase(id);
+               }
+               else
+               {
+                  i++;
+               }
+            }
+         }
+      }
+   }
+}
+
+std::array< int, 3 > GridColourIndex::cell(const cv::Vec3b & colour) const
+{
+   return {
+      (int)(colour[0] * m_scale[0]),
+      (int)(colour[1] * m_scale[1]),
+      (int)(colour[2] * m_scale[2])
+   };
+}
+
+std::size_t GridColourIndex::cellIndex(int c0, int c1, int c2) const
+{
+   return (c0 * m_cells[1] + c1) * m_cells[2] + c2;
+}
+
+void GridColourIndex::erase(int id)
+{
+   auto & ids = m_grid[m_cellOf[id]];
+   int last = ids.back();
+
+   ids[m_positionOf[id]] = last;
+   m_positionOf[last] = m_positionOf[id];
+   ids.pop_back();
+
+   m_cellOf[id] = -1;
+}
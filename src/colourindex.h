@@ -0,0 +1,79 @@
+/*
+ * ColourIndex.h
+ *
+ *  Created on: 19 Oct 2026
+ */
+
+#ifndef COLOURINDEX_H_
+#define COLOURINDEX_H_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <opencv2/core/core.hpp>
+
+namespace tc
+{
+
+// Set of the pixels of an image not yet assigned to a bucket.
+// The seeds are returned in column order, as the pixels are scanned by ThreeColours::fillBuckets.
+class ColourIndex
+{
+public:
+   typedef std::array< int, 2 > pixel_type;
+   typedef std::vector< pixel_type > pixels_type;
+
+   ColourIndex(const cv::Mat & image, const std::vector< double > & knorm, double radius);
+   virtual ~ColourIndex();
+
+   // removes the next unassigned pixel, returns false when none is left
+   virtual bool next(pixel_type & pixel) = 0;
+   // removes all the unassigned pixels closer than the radius to the colour
+   virtual void extract(const cv::Vec3b & colour, pixels_type & pixels) = 0;
+
+protected:
+   const cv::Mat & m_image;
+   const std::vector< double > & m_knorm;
+   double m_radius;
+};
+
+// Scans all the unassigned pixels for every query.
+class LinearColourIndex : public ColourIndex
+{
+public:
+   LinearColourIndex(const cv::Mat & image, const std::vector< double > & knorm, double radius);
+
+   bool next(pixel_type & pixel) override;
+   void extract(const cv::Vec3b & colour, pixels_type & pixels) override;
+
+private:
+   pixels_type m_pixels;
+};
+
+// Uniform grid over the weighted YCrCb space, with cells not smaller than the radius,
+// so that a query only visits the 27 cells around the colour.
+class GridColourIndex : public ColourIndex
+{
+public:
+   GridColourIndex(const cv::Mat & image, const std::vector< double > & knorm, double radius);
+
+   bool next(pixel_type & pixel) override;
+   void extract(const cv::Vec3b & colour, pixels_type & pixels) override;
+
+private:
+   std::array< int, 3 > cell(const cv::Vec3b & colour) const;
+   std::size_t cellIndex(int c0, int c1, int c2) const;
+   void erase(int id);
+
+   std::array< double, 3 > m_scale;
+   std::array< int, 3 > m_cells;
+   std::vector< std::vector< int > > m_grid;
+   std::vector< int > m_cellOf;
+   std::vector< int > m_positionOf;
+   std::size_t m_next;
+};
+
+}
+
+#endif // COLOURINDEX_H_
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -9,6 +11,7 @@
 #include <boost/program_options.hpp>
 #endif // SERVER
 
+#include "summary.h"
 #include "threecolours.h"
 
 #ifndef SERVER
@@ -21,6 +24,7 @@ enum ExtiValue
    OK_HELP = 1,
    ERROR_NO_FILE = -1,
    ERROR_WRONG_OUTPUT_FORMAT = -2,
+   ERROR_WRONG_INDEX = -3,
 };
 
 enum class OutputType
@@ -30,6 +34,73 @@ enum class OutputType
    CSV,
 };
 
+// Times only the bucket filling of the linear and the grid index, on an image loaded once
+class BucketsBenchmark : public tc::ThreeColours
+{
+public:
+   using tc::ThreeColours::ThreeColours;
+
+   // median time in ms of each index, over the given repetitions
+   std::array< double, 2 > time(int repetitions)
+   {
+      const std::array< Index, 2 > indices = {Index::LINEAR, Index::GRID};
+
+      auto && image = loadFile();
+
+      std::array< std::vector< double >, 2 > times;
+      for (int repetition = -1; repetition < repetitions; repetition++)
+      {
+         for (std::size_t i = 0; i < indices.size(); i++)
+         {
+            index() = indices[i];
+
+            auto start = std::chrono::steady_clock::now();
+            m_buckets[i] = fillBuckets(image);
+            auto elapsed = std::chrono::duration< double, std::milli >(std::chrono::steady_clock::now() - start).count();
+
+            // the first repetition only warms up
+            if (repetition >= 0)
+            {
+               times[i].push_back(elapsed);
+            }
+         }
+      }
+
+      std::array< double, 2 > medians;
+      for (std::size_t i = 0; i < times.size(); i++)
+      {
+         std::sort(times[i].begin(), times[i].end());
+         medians[i] = times[i][times[i].size() / 2];
+      }
+
+      return medians;
+   }
+
+   // whether the last run of both indices produced buckets of the same sizes
+   bool same() const
+   {
+      return sizes(m_buckets[0]) == sizes(m_buckets[1]);
+   }
+
+private:
+   static std::vector< std::size_t > sizes(const buckets_array_type & buckets)
+   {
+      std::vector< std::size_t > sizes;
+      for (auto & group : buckets)
+      {
+         sizes.push_back(group.size());
+         for (auto & bucket : group)
+         {
+            sizes.push_back(std::get< 0 >(bucket).size());
+         }
+      }
+
+      return sizes;
+   }
+
+   std::array< buckets_array_type, 2 > m_buckets;
+};
+
 int main(int argc, char * argv[])
 {
    if (argc == 1) {
@@ -44,7 +115,10 @@ int main(int argc, char * argv[])
    double foregroundThreshold = 80;
    double middlegroundThreshold = 45;
    bool show = false;
+   bool summarize = false;
+   bool benchmark = false;
    std::string output = "json";
+   std::string index = "grid";
 
 #ifndef SERVER
    po::options_description visible("Allowed options");
@@ -57,6 +131,9 @@ int main(int argc, char * argv[])
       ("mth,m", po::value< double >(& middlegroundThreshold)->default_value(middlegroundThreshold), "middleground threshold")
       ("show,w", "show a result example")
       ("output,o", po::value< std::string >(& output)->default_value("json"), "output type (json|xml|csv)")
+      ("index,x", po::value< std::string >(& index)->default_value("grid"), "colour index used to fill the buckets (linear|grid)")
+      ("benchmark,b", "time the bucket filling of the linear and grid indices with sizes 100, 200 and 400")
+      ("summary,a", "read the file names from stdin, one per line, and output a json summary of the whole catalogue")
    ;
 
    po::options_description hidden("Hidden options");
@@ -75,7 +152,7 @@ int main(int argc, char * argv[])
        std::cout << cmdline_options << std::endl;
        return ExtiValue::OK_HELP;
    }
-   else if (filename == "")
+   else if (filename == "" and not vm.count("summary"))
    {
       std::cerr << "Usage: " << argv[0] << " [OPTIONS] FILE" << std::endl;
 
@@ -85,9 +162,91 @@ int main(int argc, char * argv[])
    if (vm.count("show")) {
       show = true;
    }
+
+   if (vm.count("summary")) {
+      summarize = true;
+   }
+
+   if (vm.count("benchmark")) {
+      benchmark = true;
+   }
 #endif // SERVER
 
-   tc::ThreeColours threeColours(filename, size, frame, bucketThreshold, foregroundThreshold, middlegroundThreshold);
+   boost::algorithm::to_lower(output);
+   boost::algorithm::to_lower(index);
+
+   std::map< std::string, tc::ThreeColours::Index > indices = {
+      {"linear", tc::ThreeColours::Index::LINEAR},
+      {"grid", tc::ThreeColours::Index::GRID}
+   };
+
+   if (indices.count(index) == 0)
+   {
+      std::cerr << "The option -x must be one of \"linear\", \"grid\", " << index << " given" << std::endl;
+
+      return ExtiValue::ERROR_WRONG_INDEX;
+   }
+
+   if (benchmark)
+   {
+      BucketsBenchmark threeColours(filename, size, frame, bucketThreshold, foregroundThreshold, middlegroundThreshold);
+
+      std::cout << boost::format("%5s %12s %12s %8s %s") % "size" % "linear (ms)" % "grid (ms)" % "speedup" % "same" << std::endl;
+
+      for (int benchmarkSize : {100, 200, 400})
+      {
+         threeColours.size() = benchmarkSize;
+
+         auto && times = threeColours.time(5);
+
+         std::cout << boost::format("%5i %12.2f %12.2f %7.1fx %s")
+            % benchmarkSize % times[0] % times[1] % (times[0] / times[1])
+            % (threeColours.same() ? "yes" : "no")
+            << std::endl;
+      }
+
+      return ExtiValue::OK_END;
+   }
+
+   if (summarize)
+   {
+      if (output != "json")
+      {
+         std::cerr << "The option -a only supports \"json\" output, " << output << " given" << std::endl;
+
+         return ExtiValue::ERROR_WRONG_OUTPUT_FORMAT;
+      }
+
+      tc::Summary summary;
+      tc::ThreeColours threeColours("", size, frame, bucketThreshold, foregroundThreshold, middlegroundThreshold, indices.at(index));
+
+      while (std::getline(std::cin, threeColours.filename()))
+      {
+         boost::algorithm::trim(threeColours.filename());
+
+         if (threeColours.filename() == "")
+         {
+            continue;
+         }
+
+         try
+         {
+            auto colours = threeColours.run();
+            summary.add(colours, threeColours.fallback(), threeColours.distances());
+         }
+         catch (const std::runtime_error & e)
+         {
+            std::cerr << e.what() << std::endl;
+            summary.fail();
+         }
+      }
+
+      std::cout << summary.json() << std::endl;
+
+      return ExtiValue::OK_END;
+   }
+
+   tc::ThreeColours threeColours(filename, size, frame, bucketThreshold, foregroundThreshold, middlegroundThreshold, indices.at(index));
 
    auto colours = threeColours.run(show);
 
@@ -97,8 +256,6 @@ int main(int argc, char * argv[])
       {"csv", OutputType::CSV}
    };
 
-   boost::algorithm::to_lower(output);
-
    if (outputTypes.count(output) == 0)
    {
       std::cerr << "The option -o must be one of \"json\", \"xml\", \"csv\", " << output << " given" << std::endl;
@@ -0,0 +1,38 @@
+/*
+ * Norm.h
+ *
+ *  Created on: 19 Oct 2026
+ */
+
+#ifndef NORM_H_
+#define NORM_H_
+
+#include <cmath>
+#include <vector>
+
+namespace tc
+{
+
+template< typename P_ = int, typename T1_, typename T2_ >
+double norm(T1_ v1, T2_ v2)
+{
+   return ::sqrt(
+      ::pow((P_)v1[0] - (P_)v2[0], 2.0) +
+      ::pow((P_)v1[1] - (P_)v2[1], 2.0) +
+      ::pow((P_)v1[2] - (P_)v2[2], 2.0)
+   );
+}
+
+template< typename P1_ = int, typename P2_, typename T1_, typename T2_ >
+double norm(T1_ v1, T2_ v2, const std::vector< P2_ > & k)
+{
+   return ::sqrt(
+      ::pow((P1_)v1[0] - (P1_)v2[0], 2.0) * k[0] +
+      ::pow((P1_)v1[1] - (P1_)v2[1], 2.0) * k[1] +
+      ::pow((P1_)v1[2] - (P1_)v2[2], 2.0) * k[2]
+   );
+}
+
+}
+
+#endif // NORM_H_
@@ -0,0 +1,227 @@
+/*
+ * Summary.cpp
+ *
+ *  Created on: 19 Oct 2026
+ */
+
+#include "summary.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <sstream>
+
+#include <boost/format.hpp>
+
+namespace tc {
+
+namespace {
+
+// colours are quantized to 4 bits per channel before being counted
+const int QUANTIZATION_SHIFT = 4;
+const int QUANTIZATION_LEVELS = 256 >> QUANTIZATION_SHIFT;
+
+int quantize(const cv::Vec3b & colour)
+{
+   return
+      ((colour[0] >> QUANTIZATION_SHIFT) * QUANTIZATION_LEVELS +
+       (colour[1] >> QUANTIZATION_SHIFT)) * QUANTIZATION_LEVELS +
+      (colour[2] >> QUANTIZATION_SHIFT);
+}
+
+cv::Vec3b dequantize(int bin)
+{
+   const int half = 1 << (QUANTIZATION_SHIFT - 1);
+
+   return cv::Vec3b(
+      ((bin / QUANTIZATION_LEVELS / QUANTIZATION_LEVELS) << QUANTIZATION_SHIFT) + half,
+      ((bin / QUANTIZATION_LEVELS % QUANTIZATION_LEVELS) << QUANTIZATION_SHIFT) + half,
+      ((bin % QUANTIZATION_LEVELS) << QUANTIZATION_SHIFT) + half
+   );
+}
+
+}
+
+}
+
+using namespace tc;
+
+Sketch::Sketch(double max, std::size_t bins)
+   : m_max(max)
+   , m_bins(bins, 0)
+   , m_count(0)
+   , m_min(std::numeric_limits< double >::max())
+   , m_maxSeen(std::numeric_limits< double >::lowest())
+   , m_sum(0)
+{
+}
+
+void Sketch::add(double value)
+{
+   auto bin = (std::size_t)std::max(0., value / m_max * m_bins.size());
+   m_bins[std::min(bin, m_bins.size() - 1)]++;
+
+   m_count++;
+   m_min = std::min(m_min, value);
+   m_maxSeen = std::max(m_maxSeen, value);
+   m_sum += value;
+}
+
+double Sketch::quantile(double q) const
+{
+   if (m_count == 0)
+   {
+      return 0;
+   }
+
+   auto rank = (std::uint64_t)std::max(1., ::ceil(q * m_count));
+   std::uint64_t seen = 0;
+   std::size_t bin = 0;
+   for (; bin < m_bins.size() - 1; bin++)
+   {
+      seen += m_bins[bin];
+      if (seen >= rank)
+      {
+         break;
+      }
+   }
+
+   double value = (bin + .5) * m_max / m_bins.size();
+
+   return std::min(std::max(value, m_min), m_maxSeen);
+}
+
+std::uint64_t Sketch::count() const
+{
+   return m_count;
+}
+
+double Sketch::min() const
+{
+   return m_count > 0 ? m_min : 0;
+}
+
+double Sketch::max() const
+{
+   return m_count > 0 ? m_maxSeen : 0;
+}
+
+double Sketch::mean() const
+{
+   return m_count > 0 ? m_sum / m_count : 0;
+}
+
+Summary::Summary(std::size_t top)
+   : m_top(top)
+   , m_images(0)
+   , m_failed(0)
+   , m_fallbacks({0, 0, 0})
+{
+   for (auto & histogram : m_histograms)
+   {
+      histogram.assign(QUANTIZATION_LEVELS * QUANTIZATION_LEVELS * QUANTIZATION_LEVELS, 0);
+   }
+}
+
+void Summary::add(
+      const ThreeColours::colours_type & colours,
+      ThreeColours::Fallback fallback,
+      const ThreeColours::distances_type & distances
+)
+{
+   m_images++;
+   m_fallbacks[(int)fallback]++;
+
+   for (std::size_t i = 0; i < colours.size(); i++)
+   {
+      m_histograms[i][quantize(colours[i])]++;
+   }
+
+   m_distances[0].add(distances[0]);
+   m_distances[1].add(distances[1]);
+}
+
+void Summary::fail()
+{
+   m_failed++;
+}
+
+std::string Summary::json() const
+{
+   std::ostringstream stream;
+
+   stream << boost::format(
+         "{"
+            "\"images\":%1%,"
+            "\"failed\":%2%,"
+            "\"fallback\":{\"none\":%3%,\"noMiddleground\":%4%,\"middlegroundTooClose\":%5%},"
+            "\"colours\":{\"foreground\":%6%,\"middleground\":%7%,\"background\":%8%},"
+            "\"distances\":{"
+         )
+      % m_images % m_failed
+      % m_fallbacks[(int)ThreeColours::Fallback::NONE]
+      % m_fallbacks[(int)ThreeColours::Fallback::NO_MIDDLEGROUND]
+      % m_fallbacks[(int)ThreeColours::Fallback::MIDDLEGROUND_TOO_CLOSE]
+      % topColours(m_histograms[0])
+      % topColours(m_histograms[1])
+      % topColours(m_histograms[2]);
+
+   const std::array< std::string, 2 > names = {"foreground", "middleground"};
+   for (std::size_t i = 0; i < m_distances.size(); i++)
+   {
+      const auto & sketch = m_distances[i];
+      stream << boost::format(
+            "%1%\"%2%\":{"
+               "\"min\":%3$.2f,\"p05\":%4$.2f,\"p25\":%5$.2f,\"p50\":%6$.2f,"
+               "\"p75\":%7$.2f,\"p95\":%8$.2f,\"max\":%9$.2f,\"mean\":%10$.2f"
+            "}"
+         )
+         % (i > 0 ? "," : "") % names[i]
+         % sketch.min()
+         % sketch.quantile(.05) % sketch.quantile(.25) % sketch.quantile(.5)
+         % sketch.quantile(.75) % sketch.quantile(.95)
+         % sketch.max() % sketch.mean();
+   }
+
+   stream << "}}";
+
+   return stream.str();
+}
+
+std::string Summary::topColours(const histogram_type & histogram) const
+{
+   std::vector< int > bins(histogram.size());
+   std::iota(bins.begin(), bins.end(), 0);
+
+   auto top = std::min(m_top, bins.size());
+   std::partial_sort(bins.begin(), bins.begin() + top, bins.end(), [& histogram](int b1, int b2) -> bool
+   {
+      bool order;
+      if (histogram[b1] == histogram[b2])
+      {
+         order = b1 < b2;
+      }
+      else
+      {
+         order = histogram[b1] > histogram[b2];
+      }
+
+      return order;
+   });
+
+   std::ostringstream stream;
+   stream << "[";
+   for (std::size_t i = 0; i < top and histogram[bins[i]] > 0; i++)
+   {
+      // colours are BGR, hex is RGB as in the per-image output
+      auto colour = dequantize(bins[i]);
+      stream << boost::format("%1%{\"r\":%2$i,\"g\":%3$i,\"b\":%4$i,\"hex\":\"%2$02x%3$02x%4$02x\",\"count\":%5%}")
+         % (i > 0 ? "," : "")
+         % (int)colour[2] % (int)colour[1] % (int)colour[0]
+         % histogram[bins[i]];
+   }
+   stream << "]";
+
+   return stream.str();
+}
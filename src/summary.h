@@ -0,0 +1,73 @@
+/*
+ * Summary.h
+ *
+ *  Created on: 19 Oct 2026
+ */
+
+#ifndef SUMMARY_H_
+#define SUMMARY_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "threecolours.h"
+
+namespace tc
+{
+
+// Fixed-width histogram over [0, max], used to estimate quantiles in bounded memory.
+// The error of each quantile is at most half the bin width.
+class Sketch
+{
+public:
+   Sketch(double max = 280, std::size_t bins = 1120);
+
+   void add(double value);
+   double quantile(double q) const;
+
+   std::uint64_t count() const;
+   double min() const;
+   double max() const;
+   double mean() const;
+
+private:
+   double m_max;
+   std::vector< std::uint64_t > m_bins;
+   std::uint64_t m_count;
+   double m_min;
+   double m_maxSeen;
+   double m_sum;
+};
+
+// Catalogue-level statistics, accumulated one image at a time.
+// The memory used does not depend on the number of images.
+class Summary
+{
+public:
+   typedef std::vector< std::uint64_t > histogram_type;
+
+   Summary(std::size_t top = 5);
+
+   void add(const ThreeColours::colours_type & colours,
+            ThreeColours::Fallback fallback,
+            const ThreeColours::distances_type & distances);
+   void fail();
+
+   std::string json() const;
+
+private:
+   std::string topColours(const histogram_type & histogram) const;
+
+   std::size_t m_top;
+   std::uint64_t m_images;
+   std::uint64_t m_failed;
+   std::array< std::uint64_t, 3 > m_fallbacks;
+   std::array< histogram_type, 3 > m_histograms;
+   std::array< Sketch, 2 > m_distances;
+};
+
+}
+
+#endif // SUMMARY_H_
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <memory>
 #include <sys/stat.h>
 #include <utility>
 #ifdef DEBUG
@@ -19,29 +20,8 @@
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 
-namespace tc {
-
-template< typename P_ = int, typename T1_, typename T2_ >
-double norm(T1_ v1, T2_ v2)
-{
-   return ::sqrt(
-      ::pow((P_)v1[0] - (P_)v2[0], 2.0) +
-      ::pow((P_)v1[1] - (P_)v2[1], 2.0) +
-      ::pow((P_)v1[2] - (P_)v2[2], 2.0)
-   );
-}
-
-template< typename P1_ = int, typename P2_, typename T1_, typename T2_ >
-double norm(T1_ v1, T2_ v2, const std::vector< P2_ > & k)
-{
-   return ::sqrt(
-      ::pow((P1_)v1[0] - (P1_)v2[0], 2.0) * k[0] +
-      ::pow((P1_)v1[1] - (P1_)v2[1], 2.0) * k[1] +
-      ::pow((P1_)v1[2] - (P1_)v2[2], 2.0) * k[2]
-   );
-}
-
-}
+#include "colourindex.h"
+#include "norm.h"
 
 using namespace tc;
 
@@ -50,7 +30,8 @@ ThreeColours::ThreeColours(
       int size, int frame,
       double bucketThreshold,
       double foregroundThreshold,
-      double middlegroundThreshold
+      double middlegroundThreshold,
+      Index index
 )
    : m_filename(filename)
    , m_size(size)
@@ -59,6 +40,9 @@ ThreeColours::ThreeColours(
    , m_bucketThreshold(bucketThreshold)
    , m_foregroundThreshold(foregroundThreshold)
    , m_middlegroundThreshold(middlegroundThreshold)
+   , m_index(index)
+   , m_fallback(Fallback::NONE)
+   , m_distances({0, 0})
 {
 }
 
@@ -68,7 +52,13 @@ auto ThreeColours::run(bool show) throw(std::runtime_error) -> colours_type
 
    auto && buckets = fillBuckets(image);
 
-   auto && finalBuckets = processBuckets(buckets[0], buckets[1]);
+   auto && finalBuckets = processBuckets(buckets[0], buckets[1], m_fallback);
+
+   // foreground and middleground distances from the background, in the weighted YCrCb space
+   m_distances = {
+      norm(std::get< 1 >(finalBuckets[0]), std::get< 1 >(finalBuckets[2]), m_knorm),
+      norm(std::get< 1 >(finalBuckets[1]), std::get< 1 >(finalBuckets[2]), m_knorm)
+   };
 
    for (auto & bucket : finalBuckets)
    {
@@ -211,6 +201,26 @@ const double & ThreeColours::middlegroundThreshold() const
    return m_middlegroundThreshold;
 }
 
+auto ThreeColours::index() -> Index &
+{
+   return m_index;
+}
+
+auto ThreeColours::index() const -> const Index &
+{
+   return m_index;
+}
+
+auto ThreeColours::fallback() const -> Fallback
+{
+   return m_fallback;
+}
+
+auto ThreeColours::distances() const -> const distances_type &
+{
+   return m_distances;
+}
+
 cv::Mat ThreeColours::loadFile() const throw(std::runtime_error)
 {
    struct stat buffer;
@@ -220,6 +230,10 @@ cv::Mat ThreeColours::loadFile() const throw(std::runtime_error)
    }
 
    cv::Mat image = cv::imread(m_filename);
+   if (image.empty())
+   {
+      throw std::runtime_error("The file \"" + m_filename + "\" is not a valid image.");
+   }
    cv::resize(image, image, cv::Size(m_size, m_size), 0 ,0, cv::INTER_NEAREST);
    cv::Mat image2(image.size(), image.type());
    cv::bilateralFilter(image, image2, 20, 40, 10);
@@ -233,21 +247,23 @@ auto ThreeColours::fillBuckets(const cv::Mat & image) const -> buckets_array_typ
    buckets_type frameBuckets;
    buckets_type buckets;
 
-   std::vector< std::array< int, 2> > pixels;
-   for (int x = 0; x < image.size().width; x++)
+   std::unique_ptr< ColourIndex > pixels;
+   switch (m_index)
    {
-      for (int y = 0; y < image.size().height; y++)
-      {
-         pixels.push_back({x, y});
-      }
+   case Index::LINEAR:
+      pixels.reset(new LinearColourIndex(image, m_knorm, m_bucketThreshold));
+      break;
+   case Index::GRID:
+      pixels.reset(new GridColourIndex(image, m_knorm, m_bucketThreshold));
+      break;
    }
 
-   for (auto pixel = pixels.begin(); pixel != pixels.end(); pixel = pixels.begin())
+   ColourIndex::pixel_type pixel;
+   ColourIndex::pixels_type neighbours;
+   while (pixels->next(pixel))
    {
-      int x = (* pixel)[0];
-      int y = (* pixel)[1];
-
-      pixels.erase(pixel);
+      int x = pixel[0];
+      int y = pixel[1];
 
       auto p = image.at< cv::Vec3b >(y, x);
 
@@ -263,26 +279,20 @@ auto ThreeColours::fillBuckets(const cv::Mat & image) const -> buckets_array_typ
          bucket.push_back(tuplet_type(x, y, p));
       }
 
-      for (auto pixel1 = pixels.begin(); pixel1 != pixels.end(); )
+      neighbours.clear();
+      pixels->extract(p, neighbours);
+
+      for (auto & pixel1 : neighbours)
       {
-         int x1 = (* pixel1)[0];
-         int y1 = (* pixel1)[1];
+         int x1 = pixel1[0];
+         int y1 = pixel1[1];
 
          auto p1 = image.at< cv::Vec3b >(y1, x1);
 
-         if (norm(p, p1, m_knorm) < m_bucketThreshold)
-         {
-            pixels.erase(pixel1);
-
-            bucket.push_back(tuplet_type(x1, y1, p1));
-            if (x1 < m_frame or x1 > m_size - m_frame or y1 < m_frame or y1 > m_size - m_frame)
-            {
-               frameBucket.push_back(tuplet_type(x1, y1, p1));
-            }
-         }
-         else
+         bucket.push_back(tuplet_type(x1, y1, p1));
+         if (x1 < m_frame or x1 > m_size - m_frame or y1 < m_frame or y1 > m_size - m_frame)
          {
-            ++pixel1;
+            frameBucket.push_back(tuplet_type(x1, y1, p1));
          }
       }
 
@@ -299,8 +309,10 @@ auto ThreeColours::fillBuckets(const cv::Mat & image) const -> buckets_array_typ
    return {frameBuckets, buckets};
 }
 
-auto ThreeColours::processBuckets(buckets_type frameBuckets, buckets_type buckets) const -> buckets_type
+auto ThreeColours::processBuckets(buckets_type frameBuckets, buckets_type buckets, Fallback & fallback) const throw(std::runtime_error) -> buckets_type
 {
+   fallback = Fallback::NONE;
+
    bucket_tuple_type backgroundBucket;
    bucket_tuple_type foregroundBucket;
    bucket_tuple_type middlegroundBucket;
@@ -335,6 +347,11 @@ auto ThreeColours::processBuckets(buckets_type frameBuckets, buckets_type bucket
       return order;
    });
 
+   if (frameBuckets.empty())
+   {
+      throw std::runtime_error("No background could be found in \"" + m_filename + "\".");
+   }
+
    backgroundBucket = frameBuckets[0];
    frameBuckets.clear();
 
@@ -371,6 +388,11 @@ auto ThreeColours::processBuckets(buckets_type frameBuckets, buckets_type bucket
       return order;
    });
 
+   if (buckets.empty())
+   {
+      throw std::runtime_error("No foreground could be found in \"" + m_filename + "\".");
+   }
+
    foregroundBucket = buckets[0];
    buckets.erase(buckets.begin());
 
@@ -435,6 +457,7 @@ auto ThreeColours::processBuckets(buckets_type frameBuckets, buckets_type bucket
             std::cout << "mg = fg" << std::endl;
 #endif // DEBUG
             middlegroundBucket = foregroundBucket;
+            fallback = Fallback::MIDDLEGROUND_TOO_CLOSE;
             break;
          }
          previousVal = val;
@@ -443,6 +466,7 @@ auto ThreeColours::processBuckets(buckets_type frameBuckets, buckets_type bucket
    else
    {
       middlegroundBucket = foregroundBucket;
+      fallback = Fallback::NO_MIDDLEGROUND;
    }
 
    return {foregroundBucket, middlegroundBucket, backgroundBucket};
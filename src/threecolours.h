@@ -28,11 +28,26 @@ public:
    typedef std::tuple< bucket_type, cv::Vec3b > bucket_tuple_type;
    typedef std::vector< bucket_tuple_type > buckets_type;
    typedef std::array< buckets_type, 2 > buckets_array_type;
+   typedef std::array< double, 2 > distances_type;
+
+   enum class Index
+   {
+      LINEAR, // every seed scans all the remaining pixels
+      GRID, // every seed visits only the near cells of a grid over the colour space
+   };
+
+   enum class Fallback
+   {
+      NONE,
+      NO_MIDDLEGROUND, // only one bucket besides the background
+      MIDDLEGROUND_TOO_CLOSE, // the middleground could not be moved away from the background
+   };
 
    ThreeColours(const std::string & filename = "", int size = 100,
                 int frame = 10, double bucketThreshold = 15,
                 double foregroundThreshold = 80,
-                double middlegroundThreshold = 45);
+                double middlegroundThreshold = 45,
+                Index index = Index::GRID);
 
    colours_type run(bool show = false) throw (std::runtime_error);
 
@@ -48,12 +63,19 @@ public:
    const double & foregroundThreshold() const;
    double & middlegroundThreshold();
    const double & middlegroundThreshold() const;
+   Index & index();
+   const Index & index() const;
+
+   // results of the last run
+   Fallback fallback() const;
+   const distances_type & distances() const;
 
 protected:
    cv::Mat loadFile() const throw (std::runtime_error);
    buckets_array_type fillBuckets(const cv::Mat & image) const;
    buckets_type processBuckets(buckets_type frameBuckets,
-                               buckets_type buckets) const;
+                               buckets_type buckets,
+                               Fallback & fallback) const throw (std::runtime_error);
 
 private:
    std::string m_filename;
@@ -63,6 +85,9 @@ private:
    double m_bucketThreshold;
    double m_foregroundThreshold;
    double m_middlegroundThreshold;
+   Index m_index;
+   Fallback m_fallback;
+   distances_type m_distances;
 };
 
 }